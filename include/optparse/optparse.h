@@ -4,114 +4,21 @@
 
 // Copyright (c) 2020 Maxim Egorushkin. MIT License. See the full licence in file LICENSE.
 
+#include "parser.h"
 #include "container_io.h"
 
-#include <type_traits>
 #include <ostream>
-#include <cassert>
-#include <iosfwd>
 #include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace optparse {
 
-using std::string_view;
-
 template<class T>
 struct Type {};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template<class Container>
-struct Split {
-    Container* container;
-    char container_delimiter;
-};
-
-template<class Container>
-inline Split<Container> split(Container* c, char container_delimiter);
-
-template<class Container>
-inline Split<Container> split_comma(Container* c);
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-struct PositionalArgs {
-    char const **beg_, **end_;
-
-    char const** begin() const noexcept;
-    char const** end() const noexcept;
-    bool empty() const noexcept;
-};
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-class Option {
-private:
-    char short_name_;
-    char container_delimiter_;
-    bool optional_arg_;
-    bool cleared_ = false;
-    string_view long_name_;
-    string_view metavar_;
-    string_view help_;
-
-    typedef void(*ToOstream)(std::ostream&, void*, char);
-    typedef void(*FromStr)(string_view, void*, bool*);
-    FromStr from_str_;
-    ToOstream to_ostream_;
-    void* value_;
-
-    constexpr Option(char short_name, string_view long_name, string_view metavar, string_view help,
-           FromStr, ToOstream, void*,
-           bool optional_arg, char container_delimiter) noexcept;
-
-    friend class Parser;
-
-public:
-    // The short option name is optional. The long one is required.
-
-    template<class T>
-    constexpr Option(char short_name, string_view long_name, string_view metavar, T* value, string_view help) noexcept;
-
-    template<class Container>
-    constexpr Option(char short_name, string_view long_name, string_view metavar, Split<Container> value, string_view help) noexcept;
-
-    template<class T>
-    constexpr Option(string_view long_name, string_view metavar, T* value, string_view help) noexcept;
-
-    template<class Container>
-    constexpr Option(string_view long_name, string_view metavar, Split<Container> value, string_view help) noexcept;
-};
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-class Parser {
-private:
-    std::vector<Option> options_;
-    bool help_;
-
-public:
-    Parser();
-
-    template<class... Args>
-    Parser& option(Args&&... args);
-
-    Parser& options(std::initializer_list<Option>);
-
-    PositionalArgs parse(int argc, char** argv);
-    PositionalArgs parse(int argc, char const** argv);
-
-    // Usage: if(parser.help()) std::cout << parser;
-    bool help() const noexcept;
-    std::ostream& help(std::ostream&) const;
-};
-
-std::ostream& operator<<(std::ostream&, Parser const&);
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
 bool optparse_from_str(string_view s, Type<bool>);
 float optparse_from_str(string_view s, Type<float>);
 double optparse_from_str(string_view s, Type<double>);
@@ -150,133 +57,57 @@ inline std::ostream& optparse_to_ostream(std::ostream& s, std::vector<T> const&
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-inline constexpr Option::Option(
-      char short_name
-    , string_view long_name
-    , string_view metavar
-    , string_view help
-    , FromStr from_str
-    , ToOstream to_ostream
-    , void* value
-    , bool optional_arg
-    , char container_delimiter
-    ) noexcept
-    : short_name_(short_name)
-    , container_delimiter_(container_delimiter)
-    , optional_arg_(optional_arg)
-    , long_name_(long_name)
-    , metavar_(metavar)
-    , help_(help)
-    , from_str_(from_str)
-    , to_ostream_(to_ostream)
-    , value_(value)
-{
-    assert(!long_name_.empty()); // The short option name is optional. The long one is required.
-}
-
-template<class T>
-inline constexpr Option::Option(char short_name, string_view long_name, string_view metavar, T* value, string_view help) noexcept
-    : Option(
-          short_name
-        , long_name
-        , metavar
-        , help
-        , [](string_view from, void* to, bool*) {
-              *static_cast<T*>(to) = optparse_from_str<T>(from);
-          }
-        , [](std::ostream& to, void* from, char d) {
-              optparse_to_ostream(to, *static_cast<T*>(from), d);
-          }
-        , value
-        , std::is_same<T, bool>::value // The argument is optional for bool only.
-        , 0
-        )
-{}
-
-template<class T>
-inline constexpr Option::Option(char short_name, string_view long_name, string_view metavar, Split<T> value, string_view help) noexcept
-    : Option(
-          short_name
-        , long_name
-        , metavar
-        , help
-        , [](string_view from, void* to, bool* cleared) {
-              auto c = static_cast<T*>(to);
-              if(!*cleared) {
-                  *cleared = true;
-                  c->clear();
-              }
-              c->push_back(optparse_from_str<typename T::value_type>(from));
-          }
-        , [](std::ostream& to, void* from, char d) {
-              optparse_to_ostream(to, *static_cast<T*>(from), d);
-          }
-        , value.container
-        , false
-        , value.container_delimiter
-        )
-{}
-
 template<class T>
-inline constexpr Option::Option(string_view long_name, string_view metavar, T* value, string_view help) noexcept
-    : Option('\0', long_name, metavar, value, help)
-{}
-
-template<class Container>
-inline constexpr Option::Option(string_view long_name, string_view metavar, Split<Container> value, string_view help) noexcept
-    : Option('\0', long_name, metavar, value, help)
-{}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-template<class... Args>
-inline Parser& Parser::option(Args&&... args) {
-    options_.emplace_back(std::forward<Args>(args)...);
-    return *this;
-}
-
-inline Parser& Parser::options(std::initializer_list<Option> args) {
-    options_.insert(options_.end(), args.begin(), args.end());
-    return *this;
+void Option::from_str(string_view from, void* to, bool*) {
+    *static_cast<T*>(to) = optparse_from_str<T>(from);
 }
 
-inline std::ostream& operator<<(std::ostream& s, Parser const& p) {
-    return p.help(s);
-}
-
-inline PositionalArgs Parser::parse(int argc, char const** argv) {
-    return this->parse(argc, const_cast<char**>(argv));
-}
-
-inline bool Parser::help() const noexcept {
-    return help_;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
 template<class Container>
-inline Split<Container> split(Container* c, char container_delimiter) {
-    return {c, container_delimiter};
+void Option::container_from_str(string_view from, void* to, bool* cleared) {
+    auto c = static_cast<Container*>(to);
+    if(!*cleared) {
+        *cleared = true;
+        c->clear();
+    }
+    c->push_back(optparse_from_str<typename Container::value_type>(from));
 }
 
-template<class Container>
-inline Split<Container> split_comma(Container* c) {
-    return {c, ','};
+template<class T>
+void Option::to_ostream(std::ostream& to, void* from, char container_delimiter) {
+    optparse_to_ostream(to, *static_cast<T*>(from), container_delimiter);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-inline char const** PositionalArgs::begin() const noexcept {
-    return beg_;
-}
-
-inline char const** PositionalArgs::end() const noexcept {
-    return end_;
-}
-
-inline bool PositionalArgs::empty() const noexcept {
-    return beg_ == end_;
-}
+// The conversions for these types are explicitly instantiated in libcoptpase.a.
+
+#define OPTPARSE_BUILTIN_TYPES(X) \
+    X(bool) \
+    X(char) \
+    X(signed char) \
+    X(unsigned char) \
+    X(short) \
+    X(unsigned short) \
+    X(int) \
+    X(unsigned int) \
+    X(long) \
+    X(unsigned long) \
+    X(long long) \
+    X(unsigned long long) \
+    X(float) \
+    X(double) \
+    X(long double) \
+    X(char const*) \
+    X(string_view)
+
+#define OPTPARSE_EXTERN_TEMPLATE(T) \
+    extern template void Option::from_str<T>(string_view, void*, bool*); \
+    extern template void Option::to_ostream<T>(std::ostream&, void*, char); \
+    extern template void Option::container_from_str<std::vector<T>>(string_view, void*, bool*); \
+    extern template void Option::to_ostream<std::vector<T>>(std::ostream&, void*, char);
+
+OPTPARSE_BUILTIN_TYPES(OPTPARSE_EXTERN_TEMPLATE)
+
+#undef OPTPARSE_EXTERN_TEMPLATE
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
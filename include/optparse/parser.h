@@ -0,0 +1,431 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+#ifndef OPTPARSE_PARSER_H_INCLUDED
+#define OPTPARSE_PARSER_H_INCLUDED
+
+// Copyright (c) 2020 Maxim Egorushkin. MIT License. See the full licence in file LICENSE.
+
+// The lightweight header. It declares Option and Parser without pulling in <ostream> and <vector>,
+// so that it is cheap to include in many translation units. The value conversions are only
+// declared here. libcoptpase.a provides them for the built-in optparse_from_str types and
+// std::vector of these. Include optparse/optparse.h for options of other types.
+
+#include <string_view>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+#include <iosfwd>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace optparse {
+
+using std::string_view;
+
+// Align a configuration struct with alignas(CACHE_LINE_SIZE) to have it start on a cache line boundary.
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Container>
+struct Split {
+    Container* container;
+    char container_delimiter;
+};
+
+template<class Container>
+inline Split<Container> split(Container* c, char container_delimiter);
+
+template<class Container>
+inline Split<Container> split_comma(Container* c);
+
+template<class Container, class Config>
+struct SplitMember {
+    Container Config::* container;
+    char container_delimiter;
+};
+
+template<class Container, class Config>
+inline SplitMember<Container, Config> split(Container Config::* c, char container_delimiter);
+
+template<class Container, class Config>
+inline SplitMember<Container, Config> split_comma(Container Config::* c);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct PositionalArgs {
+    char const **beg_, **end_;
+
+    char const** begin() const noexcept;
+    char const** end() const noexcept;
+    bool empty() const noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Option {
+private:
+    char short_name_;
+    char container_delimiter_;
+    bool optional_arg_;
+    bool cleared_ = false;
+    bool member_ = false;
+    string_view long_name_;
+    string_view metavar_;
+    string_view help_;
+
+    typedef void(*ToOstream)(std::ostream&, void*, char);
+    typedef void(*FromStr)(string_view, void*, bool*);
+    FromStr from_str_;
+    ToOstream to_ostream_;
+    union {
+        void* value_;
+        std::size_t offset_; // Of the member in the configuration struct, when member_ is set.
+    };
+
+    constexpr Option(char short_name, string_view long_name, string_view metavar, string_view help,
+           FromStr, ToOstream, void*,
+           bool optional_arg, char container_delimiter) noexcept;
+
+    // Defined in optparse/optparse.h.
+    template<class T>
+    static void from_str(string_view from, void* to, bool* cleared);
+    template<class Container>
+    static void container_from_str(string_view from, void* to, bool* cleared);
+    template<class T>
+    static void to_ostream(std::ostream& to, void* from, char container_delimiter);
+
+    void* value(void* config) const noexcept;
+
+    friend class Parser;
+    template<class Config> friend class ConfigParser;
+
+public:
+    // The short option name is optional. The long one is required.
+
+    template<class T>
+    constexpr Option(char short_name, string_view long_name, string_view metavar, T* value, string_view help) noexcept;
+
+    template<class Container>
+    constexpr Option(char short_name, string_view long_name, string_view metavar, Split<Container> value, string_view help) noexcept;
+
+    template<class T>
+    constexpr Option(string_view long_name, string_view metavar, T* value, string_view help) noexcept;
+
+    template<class Container>
+    constexpr Option(string_view long_name, string_view metavar, Split<Container> value, string_view help) noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Parser {
+private:
+    struct Impl;
+    Impl* impl_;
+
+    // config is the struct the member options refer to.
+    PositionalArgs parse(int argc, char** argv, bool collect, void* config);
+    std::ostream& help(std::ostream&, void const* config) const;
+
+    template<class Config> friend class ConfigParser;
+
+public:
+    Parser();
+    ~Parser();
+
+    // The help option refers to the parser, hence it is movable but not copyable.
+    Parser(Parser&&) noexcept;
+    Parser& operator=(Parser&&) noexcept;
+
+    template<class... Args>
+    Parser& option(Args&&... args);
+
+    Parser& options(std::initializer_list<Option>);
+
+    // Permutes argv, so that the positional arguments end up at its end.
+    PositionalArgs parse(int argc, char** argv);
+    PositionalArgs parse(int argc, char const** argv);
+
+    // Leaves argv intact and collects the positional arguments in one pass into an array owned by
+    // the parser. The returned PositionalArgs is valid until the next parse/parse_collect call.
+    PositionalArgs parse_collect(int argc, char const* const* argv);
+
+    // Usage: if(parser.help()) std::cout << parser;
+    bool help() const noexcept;
+    std::ostream& help(std::ostream&) const;
+};
+
+std::ostream& operator<<(std::ostream&, Parser const&);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Binds options to members of a configuration struct, rather than to separate variables, so that
+// parsing fills one contiguous struct. The options store member offsets, which refer to the
+// struct passed to parse. help() outputs the values of a default-constructed Config.
+//
+// Usage:
+//     struct alignas(optparse::CACHE_LINE_SIZE) Config { int threads = 1; };
+//     optparse::ConfigParser<Config> parser;
+//     parser.option('t', "threads", "N", &Config::threads, "number of threads, default is %value.");
+//     Config config;
+//     parser.parse(config, argc, argv);
+
+template<class Config>
+class ConfigParser {
+private:
+    Parser parser_;
+    Config defaults_{};
+
+    template<class T>
+    ConfigParser& bind(Option o, T const& member_of_defaults);
+
+public:
+    template<class T>
+    ConfigParser& option(char short_name, string_view long_name, string_view metavar, T Config::* member, string_view help);
+
+    template<class Container>
+    ConfigParser& option(char short_name, string_view long_name, string_view metavar, SplitMember<Container, Config> member, string_view help);
+
+    template<class T>
+    ConfigParser& option(string_view long_name, string_view metavar, T Config::* member, string_view help);
+
+    template<class Container>
+    ConfigParser& option(string_view long_name, string_view metavar, SplitMember<Container, Config> member, string_view help);
+
+    PositionalArgs parse(Config& config, int argc, char** argv);
+    PositionalArgs parse(Config& config, int argc, char const** argv);
+    PositionalArgs parse_collect(Config& config, int argc, char const* const* argv);
+
+    Config const& defaults() const noexcept;
+
+    // Usage: if(parser.help()) std::cout << parser;
+    bool help() const noexcept;
+    std::ostream& help(std::ostream&) const;
+};
+
+template<class Config>
+std::ostream& operator<<(std::ostream&, ConfigParser<Config> const&);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline constexpr Option::Option(
+      char short_name
+    , string_view long_name
+    , string_view metavar
+    , string_view help
+    , FromStr from_str
+    , ToOstream to_ostream
+    , void* value
+    , bool optional_arg
+    , char container_delimiter
+    ) noexcept
+    : short_name_(short_name)
+    , container_delimiter_(container_delimiter)
+    , optional_arg_(optional_arg)
+    , long_name_(long_name)
+    , metavar_(metavar)
+    , help_(help)
+    , from_str_(from_str)
+    , to_ostream_(to_ostream)
+    , value_(value)
+{
+    assert(!long_name_.empty()); // The short option name is optional. The long one is required.
+}
+
+inline void* Option::value(void* config) const noexcept {
+    return member_ ? static_cast<char*>(config) + offset_ : value_;
+}
+
+template<class T>
+inline constexpr Option::Option(char short_name, string_view long_name, string_view metavar, T* value, string_view help) noexcept
+    : Option(
+          short_name
+        , long_name
+        , metavar
+        , help
+        , &Option::from_str<T>
+        , &Option::to_ostream<T>
+        , value
+        , std::is_same<T, bool>::value // The argument is optional for bool only.
+        , 0
+        )
+{}
+
+template<class T>
+inline constexpr Option::Option(char short_name, string_view long_name, string_view metavar, Split<T> value, string_view help) noexcept
+    : Option(
+          short_name
+        , long_name
+        , metavar
+        , help
+        , &Option::container_from_str<T>
+        , &Option::to_ostream<T>
+        , value.container
+        , false
+        , value.container_delimiter
+        )
+{}
+
+template<class T>
+inline constexpr Option::Option(string_view long_name, string_view metavar, T* value, string_view help) noexcept
+    : Option('\0', long_name, metavar, value, help)
+{}
+
+template<class Container>
+inline constexpr Option::Option(string_view long_name, string_view metavar, Split<Container> value, string_view help) noexcept
+    : Option('\0', long_name, metavar, value, help)
+{}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline Parser::Parser(Parser&& other) noexcept
+    : impl_(other.impl_)
+{
+    other.impl_ = nullptr;
+}
+
+inline Parser& Parser::operator=(Parser&& other) noexcept {
+    std::swap(impl_, other.impl_);
+    return *this;
+}
+
+template<class... Args>
+inline Parser& Parser::option(Args&&... args) {
+    return this->options({Option(std::forward<Args>(args)...)});
+}
+
+inline std::ostream& operator<<(std::ostream& s, Parser const& p) {
+    return p.help(s);
+}
+
+inline PositionalArgs Parser::parse(int argc, char** argv) {
+    return this->parse(argc, argv, false, nullptr);
+}
+
+inline PositionalArgs Parser::parse(int argc, char const** argv) {
+    return this->parse(argc, const_cast<char**>(argv), false, nullptr);
+}
+
+inline PositionalArgs Parser::parse_collect(int argc, char const* const* argv) {
+    return this->parse(argc, const_cast<char**>(argv), true, nullptr);
+}
+
+inline std::ostream& Parser::help(std::ostream& s) const {
+    return this->help(s, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Config>
+template<class T>
+inline ConfigParser<Config>& ConfigParser<Config>::bind(Option o, T const& member_of_defaults) {
+    o.member_ = true;
+    o.offset_ = reinterpret_cast<char const*>(&member_of_defaults) - reinterpret_cast<char const*>(&defaults_);
+    parser_.options({o});
+    return *this;
+}
+
+template<class Config>
+template<class T>
+inline ConfigParser<Config>& ConfigParser<Config>::option(char short_name, string_view long_name, string_view metavar, T Config::* member, string_view help) {
+    auto& m = defaults_.*member;
+    return this->bind(Option(short_name, long_name, metavar, &m, help), m);
+}
+
+template<class Config>
+template<class Container>
+inline ConfigParser<Config>& ConfigParser<Config>::option(char short_name, string_view long_name, string_view metavar, SplitMember<Container, Config> member, string_view help) {
+    auto& m = defaults_.*member.container;
+    return this->bind(Option(short_name, long_name, metavar, split(&m, member.container_delimiter), help), m);
+}
+
+template<class Config>
+template<class T>
+inline ConfigParser<Config>& ConfigParser<Config>::option(string_view long_name, string_view metavar, T Config::* member, string_view help) {
+    return this->option('\0', long_name, metavar, member, help);
+}
+
+template<class Config>
+template<class Container>
+inline ConfigParser<Config>& ConfigParser<Config>::option(string_view long_name, string_view metavar, SplitMember<Container, Config> member, string_view help) {
+    return this->option('\0', long_name, metavar, member, help);
+}
+
+template<class Config>
+inline PositionalArgs ConfigParser<Config>::parse(Config& config, int argc, char** argv) {
+    return parser_.parse(argc, argv, false, &config);
+}
+
+template<class Config>
+inline PositionalArgs ConfigParser<Config>::parse(Config& config, int argc, char const** argv) {
+    return parser_.parse(argc, const_cast<char**>(argv), false, &config);
+}
+
+template<class Config>
+inline PositionalArgs ConfigParser<Config>::parse_collect(Config& config, int argc, char const* const* argv) {
+    return parser_.parse(argc, const_cast<char**>(argv), true, &config);
+}
+
+template<class Config>
+inline Config const& ConfigParser<Config>::defaults() const noexcept {
+    return defaults_;
+}
+
+template<class Config>
+inline bool ConfigParser<Config>::help() const noexcept {
+    return parser_.help();
+}
+
+template<class Config>
+inline std::ostream& ConfigParser<Config>::help(std::ostream& s) const {
+    return parser_.help(s, &defaults_);
+}
+
+template<class Config>
+inline std::ostream& operator<<(std::ostream& s, ConfigParser<Config> const& p) {
+    return p.help(s);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Container>
+inline Split<Container> split(Container* c, char container_delimiter) {
+    return {c, container_delimiter};
+}
+
+template<class Container>
+inline Split<Container> split_comma(Container* c) {
+    return {c, ','};
+}
+
+template<class Container, class Config>
+inline SplitMember<Container, Config> split(Container Config::* c, char container_delimiter) {
+    return {c, container_delimiter};
+}
+
+template<class Container, class Config>
+inline SplitMember<Container, Config> split_comma(Container Config::* c) {
+    return {c, ','};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline char const** PositionalArgs::begin() const noexcept {
+    return beg_;
+}
+
+inline char const** PositionalArgs::end() const noexcept {
+    return end_;
+}
+
+inline bool PositionalArgs::empty() const noexcept {
+    return beg_ == end_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // optparse
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // OPTPARSE_PARSER_H_INCLUDED
@@ -0,0 +1,75 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+
+// Copyright (c) 2020 Maxim Egorushkin. MIT License. See the full licence in file LICENSE.
+
+// Compares Parser::parse, which permutes argv, with Parser::parse_collect, which doesn't, on a
+// command line with many positional arguments interleaved with options.
+
+#include <optparse/optparse.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using optparse::PositionalArgs;
+using optparse::Parser;
+
+constexpr int ARGS = 100000;
+constexpr int RUNS = 5;
+
+template<class F>
+double best_of(F f) {
+    auto best = std::chrono::steady_clock::duration::max();
+    for(int run = 0; run < RUNS; ++run) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, t1 - t0);
+    }
+    return std::chrono::duration<double, std::milli>(best).count();
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main() {
+    // "prog pos0 --int=1 pos2 --int=3 ...".
+    std::vector<std::string> strings;
+    strings.reserve(ARGS);
+    strings.emplace_back("prog");
+    for(int i = 1; i < ARGS; ++i)
+        strings.push_back(i % 2 ? "pos" + std::to_string(i) : "--int=" + std::to_string(i));
+
+    std::vector<char*> argv;
+    for(auto& s : strings)
+        argv.push_back(s.data());
+    argv.push_back(nullptr);
+
+    int value = 0;
+    Parser parser;
+    parser.option('i', "int", "INT", &value, "int option.");
+
+    size_t positional = 0;
+    std::vector<char*> av(argv.size());
+    auto permute = best_of([&]() {
+        av = argv; // parse permutes argv.
+        auto p = parser.parse(ARGS, av.data());
+        positional = p.end() - p.begin();
+    });
+    std::cout << "parse         " << ARGS << " args, " << positional << " positional: " << permute << "ms\n";
+
+    auto collect = best_of([&]() {
+        auto p = parser.parse_collect(ARGS, argv.data());
+        positional = p.end() - p.begin();
+    });
+    std::cout << "parse_collect " << ARGS << " args, " << positional << " positional: " << collect << "ms\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
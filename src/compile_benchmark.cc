@@ -0,0 +1,44 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+
+// Copyright (c) 2020 Maxim Egorushkin. MIT License. See the full licence in file LICENSE.
+
+// A typical translation unit that declares options. make run_compile_benchmark compiles it with
+// OPTPARSE_HEADER set to <optparse/optparse.h> and <optparse/parser.h> and reports the compile time
+// and the object file size for each.
+
+#ifndef OPTPARSE_HEADER
+#define OPTPARSE_HEADER <optparse/optparse.h>
+#endif
+
+#include OPTPARSE_HEADER
+
+#include <vector>
+
+using optparse::string_view;
+
+bool a1 = false;
+int a2 = 0;
+unsigned a3 = 0;
+long a4 = 0;
+double a5 = 0;
+string_view a6 = "empty";
+char const* a7 = "empty";
+std::vector<int> a8{1, 2, 3};
+std::vector<double> a9;
+std::vector<string_view> a10;
+
+optparse::PositionalArgs parse_command_line(optparse::Parser& parser, int ac, char** av) {
+    parser
+        .option('b', "bool", "BOOL",  &a1, "bool option, value is %value.")
+        .option('i', "int", "INT", &a2, "int option, value is %value.")
+        .option('u', "unsigned", "UNSIGNED", &a3, "unsigned option, value is %value.")
+        .option('l', "long", "LONG", &a4, "long option, value is %value.")
+        .option('d', "double", "DOUBLE", &a5, "double option, value is %value.")
+        .option('s', "string", "STRING", &a6, "string option, value is %value.")
+        .option('c', "cstring", "STRING", &a7, "C string option, value is %value.")
+        .option('v', "ints", "LIST", optparse::split_comma(&a8), "an int vector option, value is %value.")
+        .option("doubles", "LIST", optparse::split_comma(&a9), "a double vector option, value is %value.")
+        .option("strings", "LIST", optparse::split(&a10, ':'), "a string vector option, value is %value.")
+        ;
+    return parser.parse(ac, av);
+}
@@ -72,25 +72,62 @@ unsigned long long optparse::optparse_from_str(string_view s, Type<unsigned long
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define OPTPARSE_INSTANTIATE(T) \
+    template void Option::from_str<T>(string_view, void*, bool*); \
+    template void Option::to_ostream<T>(std::ostream&, void*, char); \
+    template void Option::container_from_str<std::vector<T>>(string_view, void*, bool*); \
+    template void Option::to_ostream<std::vector<T>>(std::ostream&, void*, char);
+
+namespace optparse {
+OPTPARSE_BUILTIN_TYPES(OPTPARSE_INSTANTIATE)
+} // namespace optparse
+
+#undef OPTPARSE_INSTANTIATE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Parser::Impl {
+    std::vector<Option> options;
+    std::vector<char const*> positional;
+    bool help = false;
+};
+
 Parser::Parser()
-    : help_()
+    : impl_(new Impl)
 {
-    this->option('h', "help", string_view{}, &help_, "Display this help.");
+    this->option('h', "help", string_view{}, &impl_->help, "Display this help.");
+}
+
+Parser::~Parser() {
+    delete impl_;
+}
+
+Parser& Parser::options(std::initializer_list<Option> args) {
+    impl_->options.insert(impl_->options.end(), args.begin(), args.end());
+    return *this;
+}
+
+bool Parser::help() const noexcept {
+    return impl_->help;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-PositionalArgs Parser::parse(int ac, char** av)
+PositionalArgs Parser::parse(int ac, char** av, bool collect, void* config)
 {
     // Prepare the arguments for getopt_long.
-    auto option_count = options_.size();
+    auto option_count = impl_->options.size();
     ::option options[option_count + 1];
-    char optstring[1 + option_count * 3 + 1], *optstringp = optstring;
+    char optstring[2 + option_count * 3 + 1], *optstringp = optstring;
+    // '-' makes getopt_long return positional arguments in order as option 1 instead of permuting argv.
+    if(collect)
+        *optstringp++ = '-';
     *optstringp++ = ':';
     constexpr int SHORT_VALUES = std::numeric_limits<unsigned char>::max() + 1;
     int short_values[SHORT_VALUES] = {};
     for(size_t i = 0; i < option_count; ++i) {
-        auto& from = options_[i];
+        auto& from = impl_->options[i];
+        from.cleared_ = false;
         auto& to = options[i];
         to.name = from.long_name_.data();
         to.has_arg = 1 + from.optional_arg_;
@@ -111,9 +148,13 @@ PositionalArgs Parser::parse(int ac, char** av)
     // Now loop over options with getopt_long.
     struct ResetOptind { ~ResetOptind() { ::optind = 0; } } reset_optind_on_return;
     ::opterr = 0;
+    impl_->positional.clear();
     for(int c; -1 != (c = ::getopt_long(ac, av, optstring, options, nullptr));) {
         if(c < SHORT_VALUES) {
             switch(c) {
+            case 1:
+                impl_->positional.push_back(::optarg);
+                continue;
             case ':':
                 throw std::runtime_error(std::string("--") + options[::optopt].name + ": an argument is required.");
             case '?':
@@ -125,19 +166,19 @@ PositionalArgs Parser::parse(int ac, char** av)
             assert(c >= SHORT_VALUES);
         }
 
-        auto& o = options_[c - SHORT_VALUES];
+        auto& o = impl_->options[c - SHORT_VALUES];
         try {
             if(o.container_delimiter_) {
                 string_view from(::optarg);
                 for(auto cur = from.begin(); cur != from.end();) {
                     auto cur_end = std::find(cur, from.end(), o.container_delimiter_);
                     string_view element(cur, cur_end - cur);
-                    o.from_str_(element, o.value_, &o.cleared_);
+                    o.from_str_(element, o.value(config), &o.cleared_);
                     cur = cur_end + (cur_end != from.end());
                 }
             }
             else {
-                o.from_str_(o.optional_arg_ && !::optarg ? "1" : ::optarg, o.value_, &o.cleared_);
+                o.from_str_(o.optional_arg_ && !::optarg ? "1" : ::optarg, o.value(config), &o.cleared_);
             }
         }
         catch(std::bad_cast&) {
@@ -145,26 +186,32 @@ PositionalArgs Parser::parse(int ac, char** av)
         }
     };
 
+    if(collect) {
+        // The arguments following "--".
+        impl_->positional.insert(impl_->positional.end(), av + ::optind, av + ac);
+        return {impl_->positional.data(), impl_->positional.data() + impl_->positional.size()};
+    }
+
     return {const_cast<char const**>(av) + ::optind, const_cast<char const**>(av) + ac};
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::ostream& Parser::help(std::ostream& out) const {
+std::ostream& Parser::help(std::ostream& out, void const* config) const {
     auto text_len = [](Option const& o) {
         return o.long_name_.size() + o.metavar_.size() + !o.metavar_.empty();
     };
 
     auto longest = text_len(*std::max_element(
-          options_.begin()
-        , options_.end()
+          impl_->options.begin()
+        , impl_->options.end()
         , [&text_len](Option const& a, Option const& b) {
               return text_len(a) < text_len(b);
           }
         ));
 
     string_view const value_placeholder = "%value";
-    for(auto const& option : options_) {
+    for(auto const& option : impl_->options) {
         out << "  ";
         if(option.short_name_)
             out << '-' << option.short_name_ << ',';
@@ -188,7 +235,7 @@ std::ostream& Parser::help(std::ostream& out) const {
         auto default_pos = option.help_.find(value_placeholder);
         if(default_pos != string_view::npos) {
             out.write(option.help_.data(), default_pos);
-            option.to_ostream_(out, option.value_, option.container_delimiter_);
+            option.to_ostream_(out, option.value(const_cast<void*>(config)), option.container_delimiter_);
             auto default_end_pos = default_pos + value_placeholder.size();
             out.write(option.help_.data() + default_end_pos, option.help_.size() - default_end_pos);
         }
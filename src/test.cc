@@ -7,7 +7,9 @@
 
 #include "optparse/optparse.h"
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 #include <string_view>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -131,6 +133,62 @@ BOOST_AUTO_TEST_CASE(long_only) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE(collect) {
+    int a1 = 0;
+    bool a2 = false;
+    optparse::Parser parser;
+    parser
+        .option('a', "int", "INT",  &a1, "int option.")
+        .option('b', "bool", "", &a2, "bool option.")
+        ;
+    char const* av[] = {"test", "pos1", "-a", "1", "pos2", "--bool", "pos3", "--", "-a", "pos4", nullptr};
+    char const* const av_copy[] = {"test", "pos1", "-a", "1", "pos2", "--bool", "pos3", "--", "-a", "pos4", nullptr};
+    auto pos_args = parser.parse_collect(sizeof av / sizeof *av - 1, av);
+    BOOST_CHECK_EQUAL(a1, 1);
+    BOOST_CHECK_EQUAL(a2, true);
+    BOOST_CHECK(std::equal(av, av + sizeof av / sizeof *av, av_copy)); // argv is not permuted.
+    std::vector<string_view> const expected{"pos1", "pos2", "pos3", "-a", "pos4"};
+    BOOST_CHECK((std::vector<string_view>(pos_args.begin(), pos_args.end()) == expected));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct alignas(optparse::CACHE_LINE_SIZE) Config {
+    bool a1 = false;
+    int a2 = 1;
+    double a3 = 0.5;
+    std::vector<int> a4{1,2,3};
+};
+
+BOOST_AUTO_TEST_CASE(config) {
+    optparse::ConfigParser<Config> parser;
+    parser
+        .option('b', "bool", "BOOL",  &Config::a1, "bool option, default is %value.")
+        .option('i', "int", "INT", &Config::a2, "int option, default is %value.")
+        .option("double", "DOUBLE", &Config::a3, "double option, default is %value.")
+        .option('v', "vector", "LIST", optparse::split_comma(&Config::a4), "a vector option, default is %value.")
+        ;
+
+    for(int i = 0; i < 2; ++i) {
+        Config config;
+        char const* av[] = {"test", "-b", "-i2", "--double", "3", "-v", "4,5", "pos1", nullptr};
+        auto pos_args = parser.parse(config, sizeof av / sizeof *av - 1, av);
+        BOOST_CHECK_EQUAL(config.a1, true);
+        BOOST_CHECK_EQUAL(config.a2, 2);
+        BOOST_CHECK_EQUAL(config.a3, 3);
+        BOOST_CHECK((config.a4 == std::vector<int>{4,5}));
+        BOOST_CHECK_EQUAL(string_view("pos1"), pos_args.begin()[0]);
+    }
+
+    BOOST_CHECK_EQUAL(parser.defaults().a2, 1);
+    std::ostringstream help;
+    help << parser;
+    BOOST_CHECK_NE(help.str().find("int option, default is 1."), std::string::npos);
+    BOOST_CHECK_NE(help.str().find("a vector option, default is 1,2,3."), std::string::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace
 
 ///////////////////////////////////////////////////////////////////////////////////////////////